@@ -0,0 +1,242 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Потоковый кеш освобождённых буферов SimpleVector.
+// Буферы группируются по классам вместимости, равным степеням двойки.
+// По умолчанию кеш выключен и выделение памяти сводится к new[] / delete[].
+// Перед помещением в кеш элементы нетривиально разрушаемых типов пересоздаются как Type(),
+// чтобы закешированный буфер не удерживал память, на которую ссылались старые элементы
+template <typename Type>
+class BufferCache {
+public:
+    // Статистика работы кеша текущего потока
+    struct Stats {
+        size_t hits = 0;           // буфер выдан из кеша
+        size_t misses = 0;         // буфер пришлось выделить через new[]
+        size_t recycled = 0;       // буфер помещён в кеш
+        size_t dropped = 0;        // буфер освобождён через delete[], минуя кеш
+        size_t cached_buffers = 0; // буферов в кеше сейчас
+        size_t cached_bytes = 0;   // байт в кеше сейчас
+    };
+
+    static constexpr size_t DEFAULT_MAX_BUFFERS_PER_CLASS = 16;
+    static constexpr size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+    BufferCache(const BufferCache&) = delete;
+    BufferCache& operator=(const BufferCache&) = delete;
+
+    ~BufferCache() {
+        Disable();
+    }
+
+    // Возвращает кеш текущего потока.
+    // Кеш создаётся при первом обращении, до этого поток не тратит на него память
+    static BufferCache& Local() {
+        thread_local BufferCache cache;
+        return cache;
+    }
+
+    // Выделяет буфер вместимостью не меньше capacity.
+    // Если кеш потока включён, capacity округляется вверх до степени двойки
+    static Type* Allocate(size_t& capacity) {
+        if (capacity == 0) {
+            return nullptr;
+        }
+        BufferCache* cache = Active();
+        if (cache == nullptr) {
+            return new Type[capacity];
+        }
+        return cache->Acquire(capacity);
+    }
+
+    // Возвращает буфер вместимостью capacity в кеш потока либо освобождает его
+    static void Deallocate(Type* buffer, size_t capacity) noexcept {
+        if (buffer == nullptr) {
+            return;
+        }
+        BufferCache* cache = Active();
+        if (cache == nullptr) {
+            delete[] buffer;
+            return;
+        }
+        cache->Recycle(buffer, capacity);
+    }
+
+    // Включает кеш для текущего потока
+    void Enable() noexcept {
+        Active() = this;
+    }
+
+    // Выключает кеш для текущего потока и освобождает все закешированные буферы
+    void Disable() noexcept {
+        if (Active() == this) {
+            Active() = nullptr;
+        }
+        Trim(0);
+    }
+
+    bool IsEnabled() const noexcept {
+        return Active() == this;
+    }
+
+    // Задаёт ограничения на число буферов в одном классе и на общий объём кеша.
+    // Лишние буферы освобождаются сразу
+    void SetLimits(size_t max_buffers_per_class, size_t max_bytes) {
+        max_buffers_per_class_ = max_buffers_per_class;
+        max_bytes_ = max_bytes;
+        for (size_t cls = 0; cls < CLASS_COUNT; ++cls) {
+            while (free_lists_[cls].size() > max_buffers_per_class_) {
+                PopAndDelete(cls);
+            }
+        }
+        Trim(max_bytes_);
+    }
+
+    size_t GetMaxBuffersPerClass() const noexcept {
+        return max_buffers_per_class_;
+    }
+
+    size_t GetMaxBytes() const noexcept {
+        return max_bytes_;
+    }
+
+    // Освобождает закешированные буферы, начиная с самых крупных,
+    // пока объём кеша не станет не больше max_bytes
+    void Trim(size_t max_bytes = 0) noexcept {
+        for (size_t cls = CLASS_COUNT; cls > 0 && stats_.cached_bytes > max_bytes; --cls) {
+            while (!free_lists_[cls - 1].empty() && stats_.cached_bytes > max_bytes) {
+                PopAndDelete(cls - 1);
+            }
+        }
+    }
+
+    const Stats& GetStats() const noexcept {
+        return stats_;
+    }
+
+    // Обнуляет счётчики, не трогая сведения о текущем содержимом кеша
+    void ResetStats() noexcept {
+        stats_.hits = 0;
+        stats_.misses = 0;
+        stats_.recycled = 0;
+        stats_.dropped = 0;
+    }
+
+private:
+    static constexpr size_t CLASS_COUNT = sizeof(size_t) * 8;
+    static constexpr size_t MAX_CLASS_CAPACITY = size_t(1) << (CLASS_COUNT - 1);
+
+    BufferCache() = default;
+
+    // Включённый кеш текущего потока либо nullptr.
+    // Тривиально разрушаемый указатель остаётся доступен и векторам,
+    // которые разрушаются после thread_local объектов потока
+    static BufferCache*& Active() noexcept {
+        thread_local BufferCache* active = nullptr;
+        return active;
+    }
+
+    static bool IsPowerOfTwo(size_t value) noexcept {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+
+    // Возвращает наименьшую степень двойки, не меньшую value, и её показатель.
+    // value не должно превышать MAX_CLASS_CAPACITY
+    static size_t RoundUpToClass(size_t value, size_t& cls) noexcept {
+        size_t rounded = 1;
+        cls = 0;
+        while (rounded < value) {
+            rounded <<= 1;
+            ++cls;
+        }
+        return rounded;
+    }
+
+    Type* Acquire(size_t& capacity) {
+        // Вместимость больше наибольшей степени двойки в size_t не округляется:
+        // такой запрос идёт напрямую в new[], который сообщит о нехватке памяти
+        if (capacity > MAX_CLASS_CAPACITY) {
+            ++stats_.misses;
+            return new Type[capacity];
+        }
+        size_t cls = 0;
+        capacity = RoundUpToClass(capacity, cls);
+        auto& free_list = free_lists_[cls];
+        if (!free_list.empty()) {
+            Type* buffer = free_list.back();
+            free_list.pop_back();
+            --stats_.cached_buffers;
+            stats_.cached_bytes -= capacity * sizeof(Type);
+            ++stats_.hits;
+            return buffer;
+        }
+        ++stats_.misses;
+        return new Type[capacity];
+    }
+
+    void Recycle(Type* buffer, size_t capacity) noexcept {
+        const size_t bytes = capacity * sizeof(Type);
+        if (!IsPowerOfTwo(capacity) || stats_.cached_bytes + bytes > max_bytes_) {
+            ++stats_.dropped;
+            delete[] buffer;
+            return;
+        }
+        size_t cls = 0;
+        RoundUpToClass(capacity, cls);
+        auto& free_list = free_lists_[cls];
+        if (free_list.size() >= max_buffers_per_class_) {
+            ++stats_.dropped;
+            delete[] buffer;
+            return;
+        }
+        // Список класса получает память при первом использовании, сразу на max_buffers_per_class_ мест,
+        // поэтому push_back ниже не выделяет память и не бросает исключений
+        if (free_list.size() == free_list.capacity()) {
+            try {
+                free_list.reserve(max_buffers_per_class_);
+            }
+            catch (...) {
+                ++stats_.dropped;
+                delete[] buffer;
+                return;
+            }
+        }
+        if constexpr (!std::is_trivially_destructible_v<Type>) {
+            if constexpr (!std::is_nothrow_default_constructible_v<Type>) {
+                // Сброс элементов может выбросить исключение, такие буферы не кешируются
+                ++stats_.dropped;
+                delete[] buffer;
+                return;
+            }
+            else {
+                // Пересоздание вместо присваивания: присваивание пустого значения
+                // может сохранить ранее выделенную память (например, у std::string)
+                for (size_t i = 0; i < capacity; ++i) {
+                    buffer[i].~Type();
+                    new (buffer + i) Type();
+                }
+            }
+        }
+        free_list.push_back(buffer);
+        ++stats_.cached_buffers;
+        stats_.cached_bytes += bytes;
+        ++stats_.recycled;
+    }
+
+    void PopAndDelete(size_t cls) noexcept {
+        delete[] free_lists_[cls].back();
+        free_lists_[cls].pop_back();
+        --stats_.cached_buffers;
+        stats_.cached_bytes -= (size_t(1) << cls) * sizeof(Type);
+    }
+
+    size_t max_buffers_per_class_ = DEFAULT_MAX_BUFFERS_PER_CLASS;
+    size_t max_bytes_ = DEFAULT_MAX_BYTES;
+    std::array<std::vector<Type*>, CLASS_COUNT> free_lists_;
+    Stats stats_;
+};
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Сжатый вектор целых чисел uint64_t.
+// Значения хранятся блоками по BLOCK_SIZE штук: первое значение блока записывается
+// в индекс блоков, остальные — как разности с предыдущим значением в зигзаг-кодировании,
+// упакованные в минимально необходимое число бит. Для отсортированных списков
+// идентификаторов разности малы, и на элемент уходит несколько бит вместо 64.
+// Последний, ещё не заполненный блок хранится без сжатия, PushBack дописывает в него
+class CompressedIntVector {
+public:
+    static constexpr size_t BLOCK_SIZE = 128;
+
+    class ConstIterator;
+
+    CompressedIntVector() = default;
+
+    // Создаёт сжатую копию вектора values
+    explicit CompressedIntVector(const SimpleVector<uint64_t>& values) {
+        for (uint64_t value : values) {
+            PushBack(value);
+        }
+        ShrinkToFit();
+    }
+
+    // Возвращает несжатую копию значений
+    SimpleVector<uint64_t> ToSimpleVector() const {
+        SimpleVector<uint64_t> result(size_);
+        for (size_t block = 0; block < GetBlockCount(); ++block) {
+            DecodeBlock(block, result.begin() + block * BLOCK_SIZE);
+        }
+        return result;
+    }
+
+    // Добавляет значение в конец вектора.
+    // Заполненный блок сжимается и переносится в упакованные данные
+    void PushBack(uint64_t value) {
+        if (tail_.GetCapacity() < BLOCK_SIZE) {
+            tail_.Reserve(BLOCK_SIZE);
+        }
+        tail_.PushBack(value);
+        ++size_;
+        if (tail_.GetSize() == BLOCK_SIZE) {
+            EncodeBlock(tail_.begin());
+            tail_.Clear();
+        }
+    }
+
+    // Возвращает значение с индексом index.
+    // Блок находится по индексу блоков за O(1), внутри блока суммируются разности
+    uint64_t operator[](size_t index) const noexcept {
+        assert(index < size_);
+        const size_t block = index / BLOCK_SIZE;
+        const size_t offset = index % BLOCK_SIZE;
+        if (block == blocks_.GetSize()) {
+            return tail_[offset];
+        }
+        const BlockInfo& info = blocks_[block];
+        uint64_t value = info.first;
+        // Блок из одинаковых значений не занимает ни одного слова данных
+        if (info.width == 0) {
+            return value;
+        }
+        const uint64_t mask = MaskOf(info.width);
+        for (size_t i = 1; i <= offset; ++i) {
+            value += UnZigZag(Unpack(data_.begin() + info.offset, i - 1, info.width, mask));
+        }
+        return value;
+    }
+
+    // Возвращает значение с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    uint64_t At(size_t index) const {
+        if (index >= size_)
+            throw out_of_range("Index is out of range"s);
+        return (*this)[index];
+    }
+
+    // Возвращает количество элементов
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Сообщает, пуст ли вектор
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает число блоков, включая незаполненный последний
+    size_t GetBlockCount() const noexcept {
+        return (size_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    }
+
+    // Распаковывает блок с индексом block в out, возвращает число значений в нём.
+    // out должен вмещать BLOCK_SIZE значений
+    size_t DecodeBlock(size_t block, uint64_t* out) const noexcept {
+        assert(block < GetBlockCount());
+        if (block == blocks_.GetSize()) {
+            copy(tail_.begin(), tail_.end(), out);
+            return tail_.GetSize();
+        }
+        const BlockInfo& info = blocks_[block];
+        out[0] = info.first;
+        // Распаковка выполняется ядром, специализированным под ширину блока,
+        // после чего разности последовательно суммируются
+        GetUnpackKernel(info.width)(data_.begin() + info.offset, out + 1);
+        for (size_t i = 1; i < BLOCK_SIZE; ++i) {
+            out[i] += out[i - 1];
+        }
+        return BLOCK_SIZE;
+    }
+
+    // Удаляет все элементы
+    void Clear() noexcept {
+        blocks_.Clear();
+        data_.Clear();
+        tail_.Clear();
+        size_ = 0;
+    }
+
+    // Перевыделяет внутренние буферы точно по размеру данных
+    void ShrinkToFit() {
+        if (data_.GetCapacity() != data_.GetSize()) {
+            SimpleVector<uint64_t> data(data_);
+            data_.swap(data);
+        }
+        if (blocks_.GetCapacity() != blocks_.GetSize()) {
+            SimpleVector<BlockInfo> blocks(blocks_);
+            blocks_.swap(blocks);
+        }
+        if (tail_.IsEmpty()) {
+            SimpleVector<uint64_t>().swap(tail_);
+        }
+    }
+
+    // Возвращает объём памяти, занимаемой вектором, в байтах
+    size_t GetMemoryUsage() const noexcept {
+        return sizeof(*this)
+            + blocks_.GetCapacity() * sizeof(BlockInfo)
+            + data_.GetCapacity() * sizeof(uint64_t)
+            + tail_.GetCapacity() * sizeof(uint64_t);
+    }
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+private:
+    // Запись индекса блоков: первое значение блока, смещение его данных и ширина разности в битах
+    struct BlockInfo {
+        uint64_t first = 0;
+        uint64_t offset : 56;
+        uint64_t width : 8;
+
+        BlockInfo() : offset(0), width(0) {
+        }
+    };
+
+    static uint64_t ZigZag(uint64_t delta) noexcept {
+        return (delta << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+    }
+
+    static constexpr uint64_t UnZigZag(uint64_t value) noexcept {
+        return (value >> 1) ^ (0 - (value & 1));
+    }
+
+    static constexpr uint64_t MaskOf(unsigned width) noexcept {
+        return width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+    }
+
+    // Извлекает index-е значение шириной width бит, mask == MaskOf(width).
+    // За данными блока с width > 0 всегда следует хотя бы одно слово, поэтому чтение
+    // words[word + 1] безопасно. Для блоков с width == 0 функцию вызывать нельзя
+    static constexpr uint64_t Unpack(const uint64_t* words, size_t index, unsigned width, uint64_t mask) noexcept {
+        const size_t bit = index * width;
+        const size_t word = bit / 64;
+        const unsigned shift = bit % 64;
+        // Двойной сдвиг вместо << (64 - shift), чтобы shift == 0 не давал сдвига на 64
+        const uint64_t low = words[word] >> shift;
+        const uint64_t high = (words[word + 1] << 1) << (63 - shift);
+        return (low | high) & mask;
+    }
+
+    // Извлекает INDEX-ю разность шириной WIDTH бит.
+    // Положение значения известно при компиляции, и соседнее слово читается,
+    // только если значение действительно пересекает границу слов
+    template <unsigned WIDTH, size_t INDEX>
+    static uint64_t UnpackAt(const uint64_t* words) noexcept {
+        constexpr size_t bit = INDEX * WIDTH;
+        constexpr size_t word = bit / 64;
+        constexpr unsigned shift = bit % 64;
+        constexpr uint64_t mask = MaskOf(WIDTH);
+        if constexpr (shift + WIDTH <= 64) {
+            return (words[word] >> shift) & mask;
+        }
+        else {
+            return ((words[word] >> shift) | (words[word + 1] << (64 - shift))) & mask;
+        }
+    }
+
+    // Распаковывает BLOCK_SIZE - 1 разностей шириной WIDTH бит полностью развёрнутым кодом
+    // без ветвлений и зависимостей между значениями
+    template <unsigned WIDTH, size_t... INDICES>
+    static void UnpackDeltas(const uint64_t* words, uint64_t* out, index_sequence<INDICES...>) noexcept {
+        ((out[INDICES] = UnZigZag(UnpackAt<WIDTH, INDICES>(words))), ...);
+    }
+
+    // Наибольшая ширина, для которой распаковка полностью разворачивается.
+    // Разности отсортированных последовательностей обычно узкие, а развёрнутые ядра
+    // для всех 65 ширин заметно замедляют компиляцию каждой единицы трансляции
+    static constexpr unsigned MAX_UNROLLED_WIDTH = 16;
+
+    // Расположение битов повторяется через каждые 64 значения (WIDTH слов),
+    // поэтому блок распаковывается двумя группами одним и тем же кодом.
+    // Широкие блоки распаковываются обычным циклом
+    template <unsigned WIDTH>
+    static void UnpackDeltas(const uint64_t* words, uint64_t* out) noexcept {
+        static_assert(BLOCK_SIZE == 128);
+        if constexpr (WIDTH == 0) {
+            fill(out, out + BLOCK_SIZE - 1, uint64_t(0));
+        }
+        else if constexpr (WIDTH <= MAX_UNROLLED_WIDTH) {
+            UnpackDeltas<WIDTH>(words, out, make_index_sequence<64>());
+            UnpackDeltas<WIDTH>(words + WIDTH, out + 64, make_index_sequence<BLOCK_SIZE - 1 - 64>());
+        }
+        else {
+            for (size_t i = 0; i < BLOCK_SIZE - 1; ++i) {
+                out[i] = UnZigZag(Unpack(words, i, WIDTH, MaskOf(WIDTH)));
+            }
+        }
+    }
+
+    using UnpackKernel = void (*)(const uint64_t*, uint64_t*);
+
+    template <size_t... WIDTHS>
+    static constexpr array<UnpackKernel, sizeof...(WIDTHS)> MakeUnpackKernels(index_sequence<WIDTHS...>) noexcept {
+        return {{&UnpackDeltas<static_cast<unsigned>(WIDTHS)>...}};
+    }
+
+    // Возвращает ядро распаковки для ширины от 0 до 64 бит
+    static UnpackKernel GetUnpackKernel(unsigned width) noexcept {
+        static constexpr array<UnpackKernel, 65> KERNELS = MakeUnpackKernels(make_index_sequence<65>());
+        return KERNELS[width];
+    }
+
+    // Сжимает BLOCK_SIZE значений и дописывает их в конец упакованных данных
+    void EncodeBlock(const uint64_t* values) {
+        array<uint64_t, BLOCK_SIZE - 1> deltas;
+        uint64_t bits = 0;
+        for (size_t i = 1; i < BLOCK_SIZE; ++i) {
+            deltas[i - 1] = ZigZag(values[i] - values[i - 1]);
+            bits |= deltas[i - 1];
+        }
+        unsigned width = 0;
+        while (width < 64 && (bits >> width) != 0) {
+            ++width;
+        }
+
+        // Последнее слово data_ служит дополнением и становится первым словом нового блока
+        if (data_.IsEmpty()) {
+            data_.PushBack(0);
+        }
+        BlockInfo info;
+        info.first = values[0];
+        info.offset = data_.GetSize() - 1;
+        info.width = width;
+        const size_t word_count = ((BLOCK_SIZE - 1) * width + 63) / 64;
+        data_.Resize(data_.GetSize() + word_count);
+        uint64_t* words = data_.begin() + info.offset;
+        for (size_t i = 0; i < deltas.size(); ++i) {
+            const size_t bit = i * width;
+            const size_t word = bit / 64;
+            const unsigned shift = bit % 64;
+            words[word] |= deltas[i] << shift;
+            if (shift + width > 64) {
+                words[word + 1] |= deltas[i] >> (64 - shift);
+            }
+        }
+        blocks_.PushBack(info);
+    }
+
+    SimpleVector<BlockInfo> blocks_;
+    SimpleVector<uint64_t> data_;
+    SimpleVector<uint64_t> tail_;
+    size_t size_ = 0;
+};
+
+// Последовательный итератор, распаковывающий значения поблочно.
+// Распакованный блок хранится в самом итераторе, поэтому это итератор ввода:
+// значения возвращаются по значению, а постфиксный инкремент не копирует блок
+class CompressedIntVector::ConstIterator {
+public:
+    using iterator_category = input_iterator_tag;
+    using value_type = uint64_t;
+    using difference_type = ptrdiff_t;
+    using pointer = void;
+    using reference = uint64_t;
+
+    // Результат постфиксного инкремента, хранящий только значение до инкремента
+    class PostIncrement {
+    public:
+        uint64_t operator*() const noexcept {
+            return value_;
+        }
+
+    private:
+        friend class ConstIterator;
+
+        explicit PostIncrement(uint64_t value) noexcept : value_(value) {
+        }
+
+        uint64_t value_;
+    };
+
+    ConstIterator() = default;
+
+    uint64_t operator*() const noexcept {
+        return buffer_[index_ % BLOCK_SIZE];
+    }
+
+    ConstIterator& operator++() noexcept {
+        ++index_;
+        if (index_ % BLOCK_SIZE == 0 && index_ < vector_->GetSize()) {
+            vector_->DecodeBlock(index_ / BLOCK_SIZE, buffer_.data());
+        }
+        return *this;
+    }
+
+    PostIncrement operator++(int) noexcept {
+        PostIncrement tmp(**this);
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const ConstIterator& other) const noexcept {
+        return index_ == other.index_;
+    }
+
+    bool operator!=(const ConstIterator& other) const noexcept {
+        return index_ != other.index_;
+    }
+
+private:
+    friend class CompressedIntVector;
+
+    ConstIterator(const CompressedIntVector* vector, size_t index) noexcept
+        : vector_(vector), index_(index) {
+        if (index_ < vector_->GetSize()) {
+            vector_->DecodeBlock(index_ / BLOCK_SIZE, buffer_.data());
+        }
+    }
+
+    const CompressedIntVector* vector_ = nullptr;
+    size_t index_ = 0;
+    // Заполняется только для разыменовываемого итератора, end() его не трогает
+    array<uint64_t, BLOCK_SIZE> buffer_;
+};
+
+inline CompressedIntVector::ConstIterator CompressedIntVector::begin() const {
+    return ConstIterator(this, 0);
+}
+
+inline CompressedIntVector::ConstIterator CompressedIntVector::end() const {
+    return ConstIterator(this, size_);
+}
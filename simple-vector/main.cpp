@@ -1,8 +1,19 @@
 #include "simple_vector.h"
+#include "compressed_int_vector.h"
+#include "radix_sort.h"
+#include "simple_span.h"
+#include "thin_vector.h"
+#include "vector_expression.h"
 
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -315,6 +326,790 @@ void TestNamedMoveConstructor() {
      cout << "Done!"s << endl << endl;
  }
 
+ void TestPushBackOwnElement() {
+     cout << "TestPushBackOwnElement"s << endl;
+     auto check = [] {
+         SimpleVector<int> ints = {100, 2, 3, 4};
+         assert(ints.GetSize() == ints.GetCapacity());
+         ints.PushBack(ints[0]);
+         assert(ints.GetSize() == 5 && ints[4] == 100 && ints[0] == 100);
+
+         SimpleVector<string> strings(4, string(100, 'x'));
+         assert(strings.GetSize() == strings.GetCapacity());
+         strings.PushBack(strings[0]);
+         assert(strings.GetSize() == 5 && strings[4].size() == 100 && strings[0].size() == 100);
+     };
+     // без кеша и с кешем буферов
+     check();
+     BufferCache<int>::Local().Enable();
+     BufferCache<string>::Local().Enable();
+     check();
+     BufferCache<int>::Local().Disable();
+     BufferCache<string>::Local().Disable();
+     cout << "Done!"s << endl << endl;
+ }
+
+ void TestBufferCache() {
+     cout << "TestBufferCache"s << endl;
+     auto& cache = BufferCache<int>::Local();
+     cache.Enable();
+     cache.ResetStats();
+     {
+         SimpleVector<int> v(Reserve(5));
+         // вместимость округляется до степени двойки
+         assert(v.GetCapacity() == 8);
+         assert(v.IsEmpty());
+     }
+     assert(cache.GetStats().cached_buffers == 1);
+     assert(cache.GetStats().cached_bytes == 8 * sizeof(int));
+     {
+         SimpleVector<int> v(7, 3);
+         assert(v.GetCapacity() == 8);
+         assert(cache.GetStats().hits == 1);
+         assert(cache.GetStats().cached_buffers == 0);
+         for (int item : v) {
+             assert(item == 3);
+         }
+     }
+     {
+         // переиспользованный буфер заполняется значениями по умолчанию
+         SimpleVector<int> v(6);
+         for (int item : v) {
+             assert(item == 0);
+         }
+         v.Resize(8);
+         assert(v[7] == 0);
+     }
+     {
+         SimpleVector<int> v;
+         for (int i = 0; i < 100; ++i) {
+             v.PushBack(i);
+         }
+         for (int i = 0; i < 100; ++i) {
+             assert(v[i] == i);
+         }
+         assert(v.GetCapacity() == 128);
+     }
+     // ограничение на число буферов в одном классе
+     cache.Trim(0);
+     cache.SetLimits(2, BufferCache<int>::DEFAULT_MAX_BYTES);
+     {
+         SimpleVector<int> a(4), b(4), c(4), d(4);
+     }
+     assert(cache.GetStats().cached_buffers == 2);
+     // ограничение на общий объём кеша
+     cache.SetLimits(BufferCache<int>::DEFAULT_MAX_BUFFERS_PER_CLASS, 1024 * sizeof(int));
+     assert(cache.GetStats().cached_bytes <= 1024 * sizeof(int));
+     {
+         SimpleVector<int> v(4096);
+     }
+     assert(cache.GetStats().cached_bytes <= 1024 * sizeof(int));
+     cache.Trim(0);
+     assert(cache.GetStats().cached_buffers == 0);
+     assert(cache.GetStats().cached_bytes == 0);
+
+     {
+         // запрос больше наибольшего класса не округляется и завершается ошибкой new[]
+         auto& wide_cache = BufferCache<int64_t>::Local();
+         wide_cache.Enable();
+         try {
+             SimpleVector<int64_t> v(Reserve(numeric_limits<size_t>::max()));
+             assert(false);
+         }
+         catch (const bad_alloc&) {
+         }
+         wide_cache.Disable();
+     }
+     cache.SetLimits(BufferCache<int>::DEFAULT_MAX_BUFFERS_PER_CLASS, BufferCache<int>::DEFAULT_MAX_BYTES);
+     cache.Disable();
+     {
+         // закешированный буфер не удерживает память старых элементов
+         auto& string_cache = BufferCache<string>::Local();
+         string_cache.Enable();
+         {
+             SimpleVector<string> v(4, string(1024 * 1024, 'x'));
+         }
+         assert(string_cache.GetStats().cached_buffers == 1);
+         {
+             SimpleVector<string> v(Reserve(4));
+             assert(v.GetCapacity() == 4);
+             for (auto it = v.begin(); it != v.begin() + v.GetCapacity(); ++it) {
+                 assert(it->empty() && it->capacity() < 1024);
+             }
+         }
+         string_cache.Disable();
+
+         auto& nested_cache = BufferCache<SimpleVector<int>>::Local();
+         nested_cache.Enable();
+         cache.Enable();
+         {
+             SimpleVector<SimpleVector<int>> v;
+             v.PushBack(SimpleVector<int>(1024));
+         }
+         // буфер вложенного вектора вернулся в кеш int, а не остался внутри закешированного слота
+         assert(nested_cache.GetStats().cached_buffers == 1);
+         assert(cache.GetStats().cached_buffers == 1);
+         nested_cache.Disable();
+         cache.Disable();
+     }
+     {
+         SimpleVector<int> v(Reserve(5));
+         assert(v.GetCapacity() == 5);
+     }
+     assert(cache.GetStats().cached_buffers == 0);
+     cout << "Done!"s << endl << endl;
+ }
+
+ void TestBufferCacheStress() {
+     cout << "TestBufferCacheStress"s << endl;
+     const size_t thread_count = 4;
+     const size_t iterations = 20000;
+     vector<thread> threads;
+     for (size_t t = 0; t < thread_count; ++t) {
+         threads.emplace_back([t] {
+             auto& cache = BufferCache<int>::Local();
+             cache.Enable();
+             cache.SetLimits(4, 1024 * 1024);
+             mt19937 generator(static_cast<unsigned>(t));
+             uniform_int_distribution<size_t> size_distribution(0, 3000);
+             SimpleVector<SimpleVector<int>> alive;
+             for (size_t i = 0; i < iterations; ++i) {
+                 const size_t size = size_distribution(generator);
+                 SimpleVector<int> v(size);
+                 iota(v.begin(), v.end(), static_cast<int>(i));
+                 if (size % 3 == 0) {
+                     v.PushBack(-1);
+                 }
+                 for (size_t j = 0; j < size; ++j) {
+                     assert(v[j] == static_cast<int>(i + j));
+                 }
+                 if (size % 5 == 0) {
+                     alive.PushBack(move(v));
+                 }
+                 if (alive.GetSize() > 8) {
+                     alive.Clear();
+                 }
+                 assert(cache.GetStats().cached_bytes <= 1024 * 1024);
+             }
+             const auto& stats = cache.GetStats();
+             assert(stats.hits > 0);
+             assert(stats.cached_buffers <= 4 * 64);
+             cache.Disable();
+         });
+     }
+     for (auto& worker : threads) {
+         worker.join();
+     }
+     cout << "Done!"s << endl << endl;
+ }
+
+ void BenchmarkBufferCache() {
+     cout << "BenchmarkBufferCache"s << endl;
+     // Много короткоживущих векторов небольшой и средней вместимости без заполнения:
+     // основная стоимость здесь — выделение и освобождение памяти
+     const size_t iterations = 1000000;
+     const size_t live_count = 8;
+     SimpleVector<size_t> capacities;
+     mt19937 generator(5);
+     for (size_t i = 0; i < 1024; ++i) {
+         capacities.PushBack(size_t(16) << (generator() % 12));
+     }
+     auto measure = [&] {
+         SimpleVector<SimpleVector<int>> live(live_count);
+         size_t checksum = 0;
+         const auto start = chrono::steady_clock::now();
+         for (size_t i = 0; i < iterations; ++i) {
+             SimpleVector<int> v(Reserve(capacities[i % capacities.GetSize()]));
+             v.PushBack(static_cast<int>(i));
+             checksum += v.GetCapacity();
+             live[i % live_count] = move(v);
+         }
+         const auto finish = chrono::steady_clock::now();
+         assert(checksum > 0);
+         return chrono::duration_cast<chrono::microseconds>(finish - start).count();
+     };
+     auto& cache = BufferCache<int>::Local();
+     cache.Disable();
+     const auto plain = measure();
+     cache.Enable();
+     cache.ResetStats();
+     const auto cached = measure();
+     const auto stats = cache.GetStats();
+     cache.Disable();
+     cout << "new[]: "s << plain << " us, cache: "s << cached << " us, hits: "s << stats.hits
+          << ", misses: "s << stats.misses << endl;
+     cout << "Done!"s << endl << endl;
+ }
+
+ int SumSpan(SimpleSpan<const int> span) {
+     return accumulate(span.begin(), span.end(), 0);
+ }
+
+ void TestSimpleSpan() {
+     cout << "TestSimpleSpan"s << endl;
+     SimpleVector<int> v = GenerateVector(10);
+     {
+         // неявное преобразование из вектора
+         SimpleSpan<int> span = v;
+         assert(span.GetSize() == v.GetSize());
+         assert(span.Data() == v.begin());
+         span[0] = 100;
+         assert(v[0] == 100);
+         span[0] = 1;
+         assert(SumSpan(v) == 55);
+         assert(SumSpan(span) == 55);
+
+         const SimpleVector<int>& const_ref = v;
+         SimpleSpan<const int> const_span = const_ref;
+         assert(const_span.Data() == v.begin());
+         assert(const_span == span);
+     }
+     {
+         SimpleSpan<int> span = v;
+         auto middle = span.Subspan(2, 3);
+         assert(middle.GetSize() == 3);
+         assert(middle.Data() == v.begin() + 2);
+         assert(middle[0] == 3 && middle[2] == 5);
+         assert(span.Subspan(7).GetSize() == 3);
+         assert(span.Subspan(10).IsEmpty());
+         assert(span.First(4).GetSize() == 4 && span.First(4)[3] == 4);
+         assert(span.Last(2)[0] == 9);
+         try {
+             span.Subspan(11);
+             assert(false);
+         }
+         catch (const out_of_range&) {
+         }
+         try {
+             span.Subspan(8, 3);
+             assert(false);
+         }
+         catch (const out_of_range&) {
+         }
+         try {
+             span.At(10);
+             assert(false);
+         }
+         catch (const out_of_range&) {
+         }
+         assert(span.At(9) == 10);
+     }
+     {
+         SimpleSpan<const int> span = v;
+         auto chunks = span.Split(4);
+         assert(chunks.GetSize() == 3);
+         assert(chunks[0].GetSize() == 4 && chunks[2].GetSize() == 2);
+         assert(chunks[1][0] == 5);
+         assert(chunks[2].Data() == v.begin() + 8);
+         int total = 0;
+         for (const auto& chunk : chunks) {
+             total += SumSpan(chunk);
+         }
+         assert(total == 55);
+         assert(SimpleSpan<int>().Split(3).IsEmpty());
+     }
+     {
+         SimpleVector<int> a = {1, 2, 3};
+         SimpleVector<int> b = {1, 2, 4};
+         SimpleSpan<int> lhs = a;
+         SimpleSpan<const int> rhs = b;
+         assert(lhs != rhs);
+         assert(lhs < rhs);
+         assert(lhs <= rhs);
+         assert(rhs > lhs);
+         assert(rhs >= lhs);
+         assert(lhs.First(2) == rhs.First(2));
+         assert(lhs.First(2) < lhs);
+         assert(lhs.First(2) != lhs);
+     }
+     cout << "Done!"s << endl << endl;
+ }
+
+ void TestThinVector() {
+     cout << "TestThinVector"s << endl;
+     static_assert(sizeof(ThinVector<string>) == sizeof(void*));
+     static_assert(sizeof(ThinVector<int, uint32_t>) == sizeof(void*));
+     {
+         ThinVector<int> v;
+         assert(v.IsEmpty());
+         assert(v.GetCapacity() == 0);
+         assert(v.begin() == v.end());
+         for (int i = 0; i < 10; ++i) {
+             v.PushBack(i);
+         }
+         assert(v.GetSize() == 10);
+         assert(v.GetCapacity() == 16);
+         v.Insert(v.begin(), -1);
+         v.Insert(v.end(), 10);
+         assert(v[0] == -1 && v[11] == 10);
+         v.Erase(v.begin());
+         for (int i = 0; i <= 10; ++i) {
+             assert(v.At(i) == i);
+         }
+         try {
+             v.At(11);
+             assert(false);
+         }
+         catch (const out_of_range&) {
+         }
+         v.Resize(3);
+         assert(v.GetSize() == 3 && v.GetCapacity() == 16);
+         v.Resize(5);
+         assert(v[3] == 0 && v[4] == 0);
+         v.PopBack();
+         assert(v.GetSize() == 4);
+
+         ThinVector<int> copy = v;
+         assert(copy == v);
+         copy[0] = 100;
+         assert(copy != v && v < copy && copy > v);
+         ThinVector<int> moved = move(copy);
+         assert(copy.IsEmpty() && moved[0] == 100);
+         // вставка ссылки на собственный элемент при переполнении
+         ThinVector<int> self = {1, 2};
+         self.PushBack(self[0]);
+         assert((self == ThinVector<int>{1, 2, 1}));
+     }
+     {
+         ThinVector<X> v(3);
+         assert(v[2].GetX() == 5);
+         v.PushBack(X(7));
+         v.Insert(v.begin() + 1, X(8));
+         assert(v.GetSize() == 5 && v[1].GetX() == 8 && v[4].GetX() == 7);
+         v.Erase(v.begin());
+         assert(v[0].GetX() == 8);
+         ThinVector<X> v2(Reserve(5));
+         assert(v2.GetCapacity() == 5 && v2.IsEmpty());
+     }
+     {
+         ThinVector<string, uint32_t> v(2, "abc"s);
+         v.PushBack("def"s);
+         assert(v.GetSize() == 3 && v[0] == "abc"s && v[2] == "def"s);
+         v.Clear();
+         assert(v.IsEmpty() && v.GetCapacity() == 4);
+     }
+     {
+         ThinVector<char, uint8_t> v;
+         for (int i = 0; i < 255; ++i) {
+             v.PushBack('a');
+         }
+         assert(v.GetSize() == 255);
+         try {
+             v.PushBack('b');
+             assert(false);
+         }
+         catch (const length_error&) {
+         }
+     }
+     {
+         // удвоение вместимости не выходит за пределы SizeType
+         ThinVector<char, uint8_t> v(Reserve(128));
+         v.Resize(200);
+         assert(v.GetSize() == 200);
+         assert(v.GetCapacity() == 255);
+         try {
+             v.Resize(256);
+             assert(false);
+         }
+         catch (const length_error&) {
+         }
+     }
+     cout << "Done!"s << endl << endl;
+ }
+
+ // Память, занимаемая вложенными векторами: объекты и их буферы в куче
+ template <typename Inner>
+ size_t NestedFootprint(const SimpleVector<Inner>& outer, size_t inner_header) {
+     size_t bytes = sizeof(outer) + outer.GetCapacity() * sizeof(Inner);
+     for (const auto& inner : outer) {
+         if (inner.GetCapacity() != 0) {
+             bytes += inner_header + inner.GetCapacity() * sizeof(*inner.begin());
+         }
+     }
+     return bytes;
+ }
+
+ void BenchmarkNestedFootprint() {
+     cout << "BenchmarkNestedFootprint"s << endl;
+     const size_t count = 1000000;
+     SimpleVector<SimpleVector<string>> simple(count);
+     SimpleVector<ThinVector<string>> thin(count);
+     SimpleVector<ThinVector<string, uint32_t>> thin32(count);
+     // каждый десятый вложенный вектор непуст
+     for (size_t i = 0; i < count; i += 10) {
+         simple[i].PushBack("x"s);
+         thin[i].PushBack("x"s);
+         thin32[i].PushBack("x"s);
+     }
+     cout << "SimpleVector<string>: "s << NestedFootprint(simple, 0) << " bytes"s << endl;
+     cout << "ThinVector<string>: "s << NestedFootprint(thin, 2 * sizeof(size_t)) << " bytes"s << endl;
+     cout << "ThinVector<string, uint32_t>: "s << NestedFootprint(thin32, 2 * sizeof(uint32_t)) << " bytes"s << endl;
+     cout << "Done!"s << endl << endl;
+ }
+
+ void TestCompressedIntVector() {
+     cout << "TestCompressedIntVector"s << endl;
+     mt19937_64 generator(42);
+     {
+         // отсортированные идентификаторы
+         SimpleVector<uint64_t> ids;
+         uint64_t id = 1000000;
+         for (size_t i = 0; i < 10000; ++i) {
+             id += generator() % 100;
+             ids.PushBack(id);
+         }
+         CompressedIntVector compressed(ids);
+         assert(compressed.GetSize() == ids.GetSize());
+         assert(compressed.GetBlockCount() == (ids.GetSize() + 127) / 128);
+         assert(compressed.ToSimpleVector() == ids);
+         for (size_t i = 0; i < ids.GetSize(); i += 37) {
+             assert(compressed[i] == ids[i]);
+             assert(compressed.At(i) == ids[i]);
+         }
+         size_t index = 0;
+         for (uint64_t value : compressed) {
+             assert(value == ids[index++]);
+         }
+         assert(index == ids.GetSize());
+         auto it = compressed.begin();
+         for (size_t i = 0; i < 200; ++i) {
+             assert(*it++ == ids[i]);
+         }
+         assert(*it == ids[200]);
+         assert(compressed.GetMemoryUsage() * 4 < ids.GetSize() * sizeof(uint64_t));
+         try {
+             compressed.At(ids.GetSize());
+             assert(false);
+         }
+         catch (const out_of_range&) {
+         }
+     }
+     {
+         // произвольные значения, включая крайние, и дописывание по одному
+         SimpleVector<uint64_t> values;
+         CompressedIntVector compressed;
+         for (size_t i = 0; i < 1000; ++i) {
+             uint64_t value = generator();
+             if (i % 7 == 0) {
+                 value = 0;
+             }
+             else if (i % 11 == 0) {
+                 value = numeric_limits<uint64_t>::max();
+             }
+             else if (i >= 256 && i < 384) {
+                 value = 5;
+             }
+             values.PushBack(value);
+             compressed.PushBack(value);
+             assert(compressed[i] == value);
+         }
+         assert(compressed.ToSimpleVector() == values);
+         assert(equal(compressed.begin(), compressed.end(), values.begin(), values.end()));
+         compressed.Clear();
+         assert(compressed.IsEmpty());
+         assert(compressed.begin() == compressed.end());
+     }
+     {
+         // произвольный доступ в блок из одинаковых значений в конце вектора
+         CompressedIntVector compressed(SimpleVector<uint64_t>(128, 7));
+         assert(compressed[5] == 7);
+         assert(compressed.At(127) == 7);
+         CompressedIntVector pushed;
+         for (size_t i = 0; i < 256; ++i) {
+             pushed.PushBack(i < 128 ? i * 3 : 9);
+         }
+         assert(pushed[130] == 9);
+         assert(pushed[255] == 9);
+         assert(pushed[127] == 381);
+     }
+     {
+         // блоки всех ширин: узкие распаковываются развёрнутым кодом, широкие — циклом
+         for (unsigned width = 1; width <= 64; ++width) {
+             const uint64_t max_step = width == 64 ? numeric_limits<uint64_t>::max() / 2 : ((uint64_t(1) << width) - 1) / 2;
+             SimpleVector<uint64_t> values(256);
+             uint64_t value = 0;
+             for (size_t i = 0; i < values.GetSize(); ++i) {
+                 values[i] = value;
+                 value += i % 3 == 0 ? max_step : generator() & max_step;
+             }
+             CompressedIntVector compressed(values);
+             assert(compressed.ToSimpleVector() == values);
+             assert(compressed[200] == values[200]);
+         }
+     }
+     {
+         CompressedIntVector compressed{SimpleVector<uint64_t>()};
+         assert(compressed.IsEmpty());
+         assert(compressed.ToSimpleVector().IsEmpty());
+     }
+     cout << "Done!"s << endl << endl;
+ }
+
+ void BenchmarkCompressedIntVector() {
+     cout << "BenchmarkCompressedIntVector"s << endl;
+     const size_t count = 5000000;
+     mt19937_64 generator(7);
+     SimpleVector<uint64_t> ids(count);
+     uint64_t id = 0;
+     for (auto& item : ids) {
+         id += 1 + generator() % 64;
+         item = id;
+     }
+     CompressedIntVector compressed(ids);
+
+     auto start = chrono::steady_clock::now();
+     const uint64_t plain_sum = accumulate(ids.begin(), ids.end(), uint64_t(0));
+     const auto plain = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+     start = chrono::steady_clock::now();
+     uint64_t compressed_sum = 0;
+     array<uint64_t, CompressedIntVector::BLOCK_SIZE> block;
+     for (size_t i = 0; i < compressed.GetBlockCount(); ++i) {
+         const size_t block_size = compressed.DecodeBlock(i, block.data());
+         compressed_sum = accumulate(block.begin(), block.begin() + block_size, compressed_sum);
+     }
+     const auto decoded = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+     assert(plain_sum == compressed_sum);
+
+     cout << "SimpleVector: "s << count * sizeof(uint64_t) << " bytes, scan "s << plain << " us"s << endl;
+     cout << "CompressedIntVector: "s << compressed.GetMemoryUsage() << " bytes, scan "s << decoded << " us"s << endl;
+     cout << "Done!"s << endl << endl;
+ }
+
+ void TestVectorExpression() {
+     cout << "TestVectorExpression"s << endl;
+     SimpleVector<double> b = {1.0, 2.0, 3.0};
+     SimpleVector<double> c = {4.0, 5.0, 6.0};
+     SimpleVector<double> d = {2.0, 2.0, 0.5};
+     {
+         SimpleVector<double> a = b + c * d;
+         assert((a == SimpleVector<double>{9.0, 12.0, 6.0}));
+         a = (c - b) / d;
+         assert((a == SimpleVector<double>{1.5, 1.5, 6.0}));
+         a = 2.0 * b + 1.0;
+         assert((a == SimpleVector<double>{3.0, 5.0, 7.0}));
+         a = 12.0 / b - c;
+         assert((a == SimpleVector<double>{8.0, 1.0, -2.0}));
+         // выражение может ссылаться на сам вектор-приёмник
+         a = a * a;
+         assert((a == SimpleVector<double>{64.0, 1.0, 4.0}));
+     }
+     {
+         // присваивание переиспользует существующий буфер
+         SimpleVector<double> a(Reserve(10));
+         const double* data = a.begin();
+         a = b + c;
+         assert(a.begin() == data);
+         assert(a.GetSize() == 3 && a.GetCapacity() == 10);
+         assert(a[2] == 9.0);
+     }
+     {
+         assert(Sum(b) == 6.0);
+         assert(Sum(b + c) == 21.0);
+         assert(Dot(b, c) == 32.0);
+         assert(Dot(b + 1.0, d) == 4.0 + 6.0 + 2.0);
+         SimpleVector<double> roots = Map(c * c, [](double x) { return sqrt(x); });
+         assert(roots == c);
+         SimpleVector<int> ints = {1, 2, 3};
+         SimpleVector<int> squares = Map(ints, [](int x) { return x * x; }) + ints;
+         assert((squares == SimpleVector<int>{2, 6, 12}));
+     }
+     {
+         SimpleVector<double> shorter = {1.0, 2.0};
+         try {
+             SimpleVector<double> a = b + shorter;
+             assert(false);
+         }
+         catch (const invalid_argument&) {
+         }
+         try {
+             Dot(b, shorter);
+             assert(false);
+         }
+         catch (const invalid_argument&) {
+         }
+     }
+     cout << "Done!"s << endl << endl;
+ }
+
+ void BenchmarkVectorExpression() {
+     cout << "BenchmarkVectorExpression"s << endl;
+     const size_t size = 1000000;
+     const int repeats = 20;
+     SimpleVector<double> b(size, 1.5);
+     SimpleVector<double> c(size, 2.5);
+     SimpleVector<double> d(size, 3.5);
+     SimpleVector<double> a(size);
+
+     auto start = chrono::steady_clock::now();
+     for (int r = 0; r < repeats; ++r) {
+         // промежуточный вектор на каждое действие
+         SimpleVector<double> product(size);
+         for (size_t i = 0; i < size; ++i) {
+             product[i] = c[i] * d[i];
+         }
+         SimpleVector<double> result(size);
+         for (size_t i = 0; i < size; ++i) {
+             result[i] = b[i] + product[i];
+         }
+         a = move(result);
+     }
+     const auto temporaries = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+     start = chrono::steady_clock::now();
+     for (int r = 0; r < repeats; ++r) {
+         a = b + c * d;
+     }
+     const auto fused = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+     assert(a[size - 1] == 1.5 + 2.5 * 3.5);
+
+     cout << "temporaries: "s << temporaries << " us, expression: "s << fused << " us"s << endl;
+     cout << "Done!"s << endl << endl;
+ }
+
+ struct Record {
+     uint32_t key = 0;
+     uint32_t payload = 0;
+ };
+
+ void TestRadixSort() {
+     cout << "TestRadixSort"s << endl;
+     mt19937_64 generator(3);
+     {
+         SimpleVector<uint32_t> v;
+         for (int i = 0; i < 10000; ++i) {
+             v.PushBack(static_cast<uint32_t>(generator()));
+         }
+         SimpleVector<uint32_t> expected = v;
+         sort(expected.begin(), expected.end());
+         RadixSort(v);
+         assert(v == expected);
+         assert(IsSorted(v));
+     }
+     {
+         // вспомогательный буфер из свободной вместимости
+         SimpleVector<int64_t> v(Reserve(200));
+         for (int i = 0; i < 100; ++i) {
+             v.PushBack(static_cast<int64_t>(generator()));
+         }
+         v.PushBack(numeric_limits<int64_t>::min());
+         v.PushBack(numeric_limits<int64_t>::max());
+         v.PushBack(0);
+         v.PushBack(-1);
+         const int64_t* data = v.begin();
+         SimpleVector<int64_t> expected = v;
+         sort(expected.begin(), expected.end());
+         RadixSort(v);
+         assert(v.begin() == data);
+         assert(v == expected);
+     }
+     {
+         SimpleVector<int8_t> small = {5, -3, 127, -128, 0, 5};
+         RadixSort(small);
+         assert((small == SimpleVector<int8_t>{-128, -3, 0, 5, 5, 127}));
+         SimpleVector<double> doubles = {3.5, -0.5, -100.25, 0.0, 1e300, -1e-300, 2.0};
+         RadixSort(doubles);
+         assert((doubles == SimpleVector<double>{-100.25, -0.5, -1e-300, 0.0, 2.0, 3.5, 1e300}));
+         SimpleVector<float> floats = {1.5f, -2.5f, 0.25f};
+         RadixSort(floats);
+         assert(IsSorted(floats));
+         SimpleVector<uint64_t> same(10, 7);
+         RadixSort(same);
+         assert(same == SimpleVector<uint64_t>(10, 7));
+     }
+     {
+         // сортировка записей по ключу устойчива
+         SimpleVector<Record> records;
+         for (uint32_t i = 0; i < 5000; ++i) {
+             records.PushBack(Record{static_cast<uint32_t>(generator() % 100), i});
+         }
+         auto key_of = [](const Record& record) {
+             return record.key;
+         };
+         RadixSort(records, key_of);
+         assert(IsSorted(records, key_of));
+         for (size_t i = 1; i < records.GetSize(); ++i) {
+             if (records[i - 1].key == records[i].key) {
+                 assert(records[i - 1].payload < records[i].payload);
+             }
+         }
+     }
+     {
+         SimpleVector<X> v;
+         for (size_t i = 0; i < 5; ++i) {
+             v.PushBack(X(5 - i));
+         }
+         RadixSort(v, [](const X& x) {
+             return x.GetX();
+         });
+         for (size_t i = 0; i < 5; ++i) {
+             assert(v[i].GetX() == i + 1);
+         }
+     }
+     {
+         SimpleVector<int> v = {1, 1, 2, 3, 3, 3, 4, 1};
+         const size_t capacity = v.GetCapacity();
+         assert(Unique(v) == 5);
+         assert((v == SimpleVector<int>{1, 2, 3, 4, 1}));
+         assert(v.GetCapacity() == capacity);
+
+         SimpleVector<int> a = {1, 3, 5, 7};
+         SimpleVector<int> b = {2, 3, 8};
+         assert((MergeSorted(a, b) == SimpleVector<int>{1, 2, 3, 3, 5, 7, 8}));
+         assert(MergeSorted(a, SimpleVector<int>()) == a);
+         SimpleVector<Record> lhs = {Record{1, 0}, Record{2, 0}};
+         SimpleVector<Record> rhs = {Record{1, 1}, Record{3, 1}};
+         auto merged = MergeSorted(lhs, rhs, [](const Record& record) {
+             return record.key;
+         });
+         assert(merged.GetSize() == 4);
+         assert(merged[0].payload == 0 && merged[1].payload == 1 && merged[3].key == 3);
+         assert(!IsSorted(SimpleVector<int>{2, 1}));
+     }
+     cout << "Done!"s << endl << endl;
+ }
+
+ void BenchmarkRadixSort() {
+     cout << "BenchmarkRadixSort"s << endl;
+     const size_t size = 10000000;
+     mt19937_64 generator(11);
+     SimpleVector<uint32_t> values(size);
+     for (auto& value : values) {
+         value = static_cast<uint32_t>(generator());
+     }
+     SimpleVector<uint32_t> sorted = values;
+
+     auto start = chrono::steady_clock::now();
+     sort(sorted.begin(), sorted.end());
+     const auto std_sort = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+     start = chrono::steady_clock::now();
+     RadixSort(values);
+     const auto radix_sort = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+     assert(values == sorted);
+     cout << "uint32_t, std::sort: "s << std_sort << " ms, RadixSort: "s << radix_sort << " ms"s << endl;
+
+     SimpleVector<Record> records(size);
+     for (uint32_t i = 0; i < size; ++i) {
+         records[i] = Record{static_cast<uint32_t>(generator()), i};
+     }
+     SimpleVector<Record> sorted_records = records;
+     auto key_of = [](const Record& record) {
+         return record.key;
+     };
+     start = chrono::steady_clock::now();
+     stable_sort(sorted_records.begin(), sorted_records.end(), [&key_of](const Record& lhs, const Record& rhs) {
+         return key_of(lhs) < key_of(rhs);
+     });
+     const auto std_records = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+     start = chrono::steady_clock::now();
+     RadixSort(records, key_of);
+     const auto radix_records = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+     assert(IsSorted(records, key_of));
+     assert(records[size / 2].payload == sorted_records[size / 2].payload);
+     cout << "Record, std::stable_sort: "s << std_records << " ms, RadixSort: "s << radix_records << " ms"s << endl;
+     cout << "Done!"s << endl << endl;
+ }
+
  void Testes() {
      const size_t size = 5;
      SimpleVector<X> v(size);
@@ -335,6 +1130,19 @@ int main() {
     TestNoncopiableInsert();
     TestNoncopiableErase();
     Testes();
+    TestSimpleSpan();
+    TestThinVector();
+    TestCompressedIntVector();
+    TestVectorExpression();
+    TestRadixSort();
+    TestPushBackOwnElement();
+    TestBufferCache();
+    TestBufferCacheStress();
+    BenchmarkBufferCache();
+    BenchmarkNestedFootprint();
+    BenchmarkCompressedIntVector();
+    BenchmarkVectorExpression();
+    BenchmarkRadixSort();
     cout << "All tests are OK" << endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+namespace radix_sort_detail {
+
+// Преобразует ключ в беззнаковое число с тем же порядком.
+// У знаковых чисел инвертируется знаковый бит, у чисел с плавающей точкой
+// отрицательные значения инвертируются целиком. NaN упорядочиваются по своему битовому представлению
+template <typename Key>
+auto ToUnsignedKey(Key key) noexcept {
+    static_assert(is_arithmetic_v<Key> && !is_same_v<Key, bool>, "Key must be an integral or floating-point type");
+    if constexpr (is_floating_point_v<Key>) {
+        static_assert(sizeof(Key) == sizeof(uint32_t) || sizeof(Key) == sizeof(uint64_t), "Unsupported floating-point type");
+        using Bits = conditional_t<sizeof(Key) == sizeof(uint32_t), uint32_t, uint64_t>;
+        Bits bits;
+        memcpy(&bits, &key, sizeof(bits));
+        const Bits sign = Bits(1) << (sizeof(Bits) * 8 - 1);
+        return (bits & sign) ? Bits(~bits) : Bits(bits | sign);
+    }
+    else {
+        using Bits = make_unsigned_t<Key>;
+        Bits bits = static_cast<Bits>(key);
+        if constexpr (is_signed_v<Key>) {
+            bits ^= Bits(1) << (sizeof(Bits) * 8 - 1);
+        }
+        return bits;
+    }
+}
+
+template <typename Type, typename KeyExtractor>
+void RadixSortImpl(SimpleVector<Type>& vector, KeyExtractor key_of) {
+    const size_t size = vector.GetSize();
+    if (size < 2) {
+        return;
+    }
+
+    using Key = decltype(ToUnsignedKey(key_of(*vector.begin())));
+    constexpr unsigned KEY_BITS = sizeof(Key) * 8;
+    // Короткие ключи сортируются по байтам, длинные — по 11 бит, чтобы сократить число проходов
+    constexpr unsigned DIGIT_BITS = KEY_BITS <= 16 ? 8 : 11;
+    constexpr unsigned PASS_COUNT = (KEY_BITS + DIGIT_BITS - 1) / DIGIT_BITS;
+    constexpr size_t RADIX = size_t(1) << DIGIT_BITS;
+    constexpr Key DIGIT_MASK = static_cast<Key>(RADIX - 1);
+
+    // Гистограммы всех разрядов строятся за один проход
+    SimpleVector<size_t> counts(PASS_COUNT * RADIX);
+    for (const Type& item : vector) {
+        const Key key = ToUnsignedKey(key_of(item));
+        for (unsigned pass = 0; pass < PASS_COUNT; ++pass) {
+            ++counts[pass * RADIX + ((key >> (pass * DIGIT_BITS)) & DIGIT_MASK)];
+        }
+    }
+
+    // Вспомогательный буфер берётся из свободной вместимости вектора, если её хватает
+    SimpleVector<Type> own_scratch;
+    Type* scratch = nullptr;
+    if (vector.GetCapacity() - size >= size) {
+        scratch = vector.begin() + size;
+    }
+    else {
+        own_scratch = SimpleVector<Type>(size);
+        scratch = own_scratch.begin();
+    }
+
+    Type* source = vector.begin();
+    Type* destination = scratch;
+    for (unsigned pass = 0; pass < PASS_COUNT; ++pass) {
+        size_t* offsets = counts.begin() + pass * RADIX;
+        const unsigned shift = pass * DIGIT_BITS;
+        // Разряд, одинаковый у всех элементов, не меняет порядок
+        if (offsets[(ToUnsignedKey(key_of(*source)) >> shift) & DIGIT_MASK] == size) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t digit = 0; digit < RADIX; ++digit) {
+            offset += exchange(offsets[digit], offset);
+        }
+        for (size_t i = 0; i < size; ++i) {
+            const size_t digit = (ToUnsignedKey(key_of(source[i])) >> shift) & DIGIT_MASK;
+            destination[offsets[digit]++] = move(source[i]);
+        }
+        std::swap(source, destination);
+    }
+    if (source != vector.begin()) {
+        move(source, source + size, vector.begin());
+    }
+}
+
+} // namespace radix_sort_detail
+
+// Сортирует вектор целых чисел или чисел с плавающей точкой поразрядной сортировкой (LSD)
+template <typename Type, enable_if_t<is_arithmetic_v<Type>, int> = 0>
+void RadixSort(SimpleVector<Type>& vector) {
+    radix_sort_detail::RadixSortImpl(vector, [](Type value) noexcept {
+        return value;
+    });
+}
+
+// Устойчиво сортирует вектор по ключу key_of(item) целого типа или типа с плавающей точкой
+template <typename Type, typename KeyExtractor>
+void RadixSort(SimpleVector<Type>& vector, KeyExtractor key_of) {
+    radix_sort_detail::RadixSortImpl(vector, key_of);
+}
+
+// Сообщает, упорядочен ли вектор по возрастанию
+template <typename Type>
+bool IsSorted(const SimpleVector<Type>& vector) {
+    return is_sorted(vector.begin(), vector.end());
+}
+
+// Сообщает, упорядочен ли вектор по возрастанию ключа key_of(item)
+template <typename Type, typename KeyExtractor>
+bool IsSorted(const SimpleVector<Type>& vector, KeyExtractor key_of) {
+    return is_sorted(vector.begin(), vector.end(), [&key_of](const Type& lhs, const Type& rhs) {
+        return key_of(lhs) < key_of(rhs);
+    });
+}
+
+// Удаляет идущие подряд повторы, сдвигая оставшиеся элементы к началу.
+// Вместимость не меняется. Возвращает новый размер вектора
+template <typename Type>
+size_t Unique(SimpleVector<Type>& vector) {
+    const auto last = unique(vector.begin(), vector.end());
+    vector.Resize(last - vector.begin());
+    return vector.GetSize();
+}
+
+// Сливает два упорядоченных вектора в новый упорядоченный вектор
+template <typename Type>
+SimpleVector<Type> MergeSorted(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+    SimpleVector<Type> result(lhs.GetSize() + rhs.GetSize());
+    merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), result.begin());
+    return result;
+}
+
+// Сливает два упорядоченных по ключу key_of(item) вектора, сохраняя порядок равных элементов
+template <typename Type, typename KeyExtractor>
+SimpleVector<Type> MergeSorted(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs, KeyExtractor key_of) {
+    SimpleVector<Type> result(lhs.GetSize() + rhs.GetSize());
+    merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), result.begin(), [&key_of](const Type& lhs, const Type& rhs) {
+        return key_of(lhs) < key_of(rhs);
+    });
+    return result;
+}
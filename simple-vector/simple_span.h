@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "simple_vector.h"
+
+// Невладеющее представление непрерывного диапазона элементов.
+// Не копирует данные: срезы Subspan, First, Last и Split указывают в тот же буфер
+template <typename Type>
+class SimpleSpan {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    SimpleSpan() noexcept = default;
+
+    // Создаёт представление size элементов, начиная с data
+    SimpleSpan(Type* data, size_t size) noexcept : data_(data), size_(size) {
+    }
+
+    // Создаёт представление всех элементов вектора
+    SimpleSpan(SimpleVector<remove_const_t<Type>>& vector) noexcept
+        : data_(vector.begin()), size_(vector.GetSize()) {
+    }
+
+    // Создаёт представление константного вектора, доступно только для SimpleSpan<const Type>
+    template <typename U = Type, enable_if_t<is_const_v<U>, int> = 0>
+    SimpleSpan(const SimpleVector<remove_const_t<Type>>& vector) noexcept
+        : data_(vector.begin()), size_(vector.GetSize()) {
+    }
+
+    // Преобразует SimpleSpan<Type> в SimpleSpan<const Type>
+    template <typename Other, enable_if_t<!is_same_v<Other, Type> && is_convertible_v<Other (*)[], Type (*)[]>, int> = 0>
+    SimpleSpan(const SimpleSpan<Other>& other) noexcept
+        : data_(other.Data()), size_(other.GetSize()) {
+    }
+
+    // Возвращает ссылку на элемент с индексом index без проверки границ
+    Type& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) const {
+        if (index >= size_)
+            throw out_of_range("Index is out of range"s);
+        return data_[index];
+    }
+
+    // Возвращает указатель на первый элемент
+    Type* Data() const noexcept {
+        return data_;
+    }
+
+    // Возвращает количество элементов в представлении
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Сообщает, пусто ли представление
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Iterator begin() const noexcept {
+        return data_;
+    }
+
+    Iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Возвращает представление count элементов, начиная с offset.
+    // Если count не задан, представление продолжается до конца.
+    // Выбрасывает исключение std::out_of_range, если диапазон выходит за границы
+    SimpleSpan Subspan(size_t offset, size_t count = NPOS) const {
+        if (offset > size_)
+            throw out_of_range("Offset is out of range"s);
+        if (count == NPOS) {
+            count = size_ - offset;
+        }
+        else if (count > size_ - offset) {
+            throw out_of_range("Count is out of range"s);
+        }
+        return SimpleSpan(data_ + offset, count);
+    }
+
+    // Возвращает представление первых count элементов
+    SimpleSpan First(size_t count) const {
+        if (count > size_)
+            throw out_of_range("Count is out of range"s);
+        return SimpleSpan(data_, count);
+    }
+
+    // Возвращает представление последних count элементов
+    SimpleSpan Last(size_t count) const {
+        if (count > size_)
+            throw out_of_range("Count is out of range"s);
+        return SimpleSpan(data_ + size_ - count, count);
+    }
+
+    // Разбивает представление на части по chunk_size элементов.
+    // Последняя часть может оказаться короче
+    SimpleVector<SimpleSpan> Split(size_t chunk_size) const {
+        if (chunk_size == 0)
+            throw invalid_argument("Chunk size must be positive"s);
+        SimpleVector<SimpleSpan> chunks(Reserve((size_ + chunk_size - 1) / chunk_size));
+        for (size_t offset = 0; offset < size_; offset += chunk_size) {
+            chunks.PushBack(SimpleSpan(data_ + offset, min(chunk_size, size_ - offset)));
+        }
+        return chunks;
+    }
+
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Lhs, typename Rhs>
+inline bool operator==(const SimpleSpan<Lhs>& lhs, const SimpleSpan<Rhs>& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Lhs, typename Rhs>
+inline bool operator!=(const SimpleSpan<Lhs>& lhs, const SimpleSpan<Rhs>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Lhs, typename Rhs>
+inline bool operator<(const SimpleSpan<Lhs>& lhs, const SimpleSpan<Rhs>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Lhs, typename Rhs>
+inline bool operator<=(const SimpleSpan<Lhs>& lhs, const SimpleSpan<Rhs>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Lhs, typename Rhs>
+inline bool operator>(const SimpleSpan<Lhs>& lhs, const SimpleSpan<Rhs>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Lhs, typename Rhs>
+inline bool operator>=(const SimpleSpan<Lhs>& lhs, const SimpleSpan<Rhs>& rhs) {
+    return !(lhs < rhs);
+}
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "array_ptr.h"
+#include "buffer_cache.h"
 
 using namespace std;
 
@@ -29,6 +30,10 @@ ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
 }
 
+// Ленивое выражение над векторами, см. vector_expression.h
+template <typename Derived>
+class VectorExpression;
+
 template <typename Type>
 class SimpleVector {
 public:
@@ -38,12 +43,14 @@ public:
     SimpleVector() noexcept = default;
 
     // Создаёт вектор из size элементов, инициализированных значением по умолчанию
-    explicit SimpleVector(size_t size) : size_(size), capacity_(size), simp_vec(size) {
-        fill(simp_vec.Get(), simp_vec.Get() + size, Type());
+    explicit SimpleVector(size_t size) : size_(size), capacity_(size), simp_vec(AllocateBuffer(capacity_)) {
+        for (auto& item : *this) {
+            item = Type();
+        }
     }
 
     // Создаёт вектор из size элементов, инициализированных значением value
-    SimpleVector(size_t size, const Type& value) : size_(size), capacity_(size), simp_vec(size) {
+    SimpleVector(size_t size, const Type& value) : size_(size), capacity_(size), simp_vec(AllocateBuffer(capacity_)) {
         fill(simp_vec.Get(), simp_vec.Get() + size, value);
     }
     
@@ -53,7 +60,7 @@ public:
     }
 
     // Создаёт вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init) : size_(init.size()), capacity_(init.size()), simp_vec(init.size()) {
+    SimpleVector(std::initializer_list<Type> init) : size_(init.size()), capacity_(init.size()), simp_vec(AllocateBuffer(capacity_)) {
         copy(init.begin(), init.end(), simp_vec.Get());
     }
 
@@ -76,7 +83,7 @@ public:
         
         simp_vec.swap(other.simp_vec);
         size_ = exchange(other.size_, 0);
-        capacity_ = exchange(other.capacity_, 0);
+        std::swap(capacity_, other.capacity_);
         return *this;
     }
 
@@ -88,7 +95,43 @@ public:
         swap(tmp);
 
         return *this;
-    }    
+    }
+
+    // Создаёт вектор, вычисляя ленивое выражение
+    template <typename Expression>
+    SimpleVector(const VectorExpression<Expression>& expression) {
+        *this = expression;
+    }
+
+    // Вычисляет ленивое выражение за один проход прямо в буфер вектора.
+    // Новый буфер выделяется, только если текущей вместимости не хватает
+    template <typename Expression>
+    SimpleVector& operator=(const VectorExpression<Expression>& expression) {
+        const Expression& expr = expression.Self();
+        const size_t size = expr.GetSize();
+        if (size > capacity_) {
+            size_t new_capacity = size;
+            ArrayPtr<Type> tmp(AllocateBuffer(new_capacity));
+            Type* data = tmp.Get();
+            for (size_t i = 0; i < size; ++i) {
+                data[i] = static_cast<Type>(expr[i]);
+            }
+            ReplaceBuffer(tmp, new_capacity);
+        }
+        else {
+            Type* data = simp_vec.Get();
+            for (size_t i = 0; i < size; ++i) {
+                data[i] = static_cast<Type>(expr[i]);
+            }
+        }
+        size_ = size;
+        return *this;
+    }
+
+    // Возвращает буфер в кеш потока либо освобождает его
+    ~SimpleVector() {
+        BufferCache<Type>::Deallocate(simp_vec.Release(), capacity_);
+    }
 
     // Возвращает ссылку на элемент с индексом index
     Type& operator[](size_t index) noexcept {
@@ -183,11 +226,10 @@ public:
             }
         }
         else if (new_size > capacity_) {
-            size_t new_capacity = max(capacity_ * 2, new_size);
-            SimpleVector<Type> tmp(new_capacity);
-            move(simp_vec.Get(), simp_vec.Get() + size_, tmp.begin());
-            simp_vec.swap(tmp.simp_vec);
-            capacity_ = new_capacity;
+            Reallocate(max(capacity_ * 2, new_size));
+            for (size_t i = size_; i < new_size; ++i) {
+                simp_vec[i] = Type();
+            }
         }
         size_ = new_size;
     }
@@ -196,11 +238,7 @@ public:
     //Резервирует нужное количество памяти
     void Reserve(size_t new_capacity) {
         if (new_capacity > capacity_) {
-            SimpleVector<Type> tmp(new_capacity);
-            move(simp_vec.Get(), simp_vec.Get() + size_, tmp.begin());
-
-            simp_vec.swap(tmp.simp_vec);
-            capacity_ = exchange(new_capacity, 0);
+            Reallocate(new_capacity);
         }
     }
 
@@ -211,17 +249,13 @@ public:
             simp_vec[size_] = item;
         }
         else {
-            if (capacity_ == 0) {
-                ++capacity_;
-            }
-            size_t new_capacity = capacity_ * 2;
-            SimpleVector<Type> tmp(new_capacity);
-
-            copy(simp_vec.Get(), simp_vec.Get() + size_, tmp.begin());
+            // item может ссылаться на элемент этого вектора,
+            // поэтому он записывается в новый буфер до освобождения старого
+            size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
+            ArrayPtr<Type> tmp(AllocateBuffer(new_capacity));
             tmp[size_] = item;
-
-            simp_vec.swap(tmp.simp_vec);
-            capacity_ = new_capacity;
+            move(simp_vec.Get(), simp_vec.Get() + size_, tmp.Get());
+            ReplaceBuffer(tmp, new_capacity);
         }
         ++size_;
     }
@@ -231,16 +265,11 @@ public:
             simp_vec[size_] = move(item);
         }
         else {
-            if (capacity_ == 0) {
-                ++capacity_;
-            }
-            size_t new_capacity = capacity_ * 2;
-            SimpleVector<Type> tmp(new_capacity);
-            move(simp_vec.Get(), simp_vec.Get() + size_, tmp.begin());
+            size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
+            ArrayPtr<Type> tmp(AllocateBuffer(new_capacity));
             tmp[size_] = move(item);
-
-            simp_vec.swap(tmp.simp_vec);
-            capacity_ = exchange(new_capacity, 0);
+            move(simp_vec.Get(), simp_vec.Get() + size_, tmp.Get());
+            ReplaceBuffer(tmp, new_capacity);
         }
         ++size_;
     }
@@ -259,18 +288,14 @@ public:
             simp_vec[position] = value;
         }
         else {
-            if (capacity_ == 0) {
-                ++capacity_;
-            }
-            size_t new_capacity = capacity_ * 2;
-            SimpleVector<Type> tmp(new_capacity);
+            size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
+            ArrayPtr<Type> tmp(AllocateBuffer(new_capacity));
 
-            copy(simp_vec.Get(), simp_vec.Get() + position, tmp.begin());
+            copy(simp_vec.Get(), simp_vec.Get() + position, tmp.Get());
             tmp[position] = value;
 
-            copy(simp_vec.Get() + position, simp_vec.Get() + size_, tmp.begin() + position + 1);
-            simp_vec.swap(tmp.simp_vec);
-            capacity_ = new_capacity;
+            copy(simp_vec.Get() + position, simp_vec.Get() + size_, tmp.Get() + position + 1);
+            ReplaceBuffer(tmp, new_capacity);
         }
         ++size_;
         return simp_vec.Get() + position;
@@ -287,18 +312,14 @@ public:
             simp_vec[position] = move(value);
         }
         else {
-            if (capacity_ == 0) {
-                ++capacity_;
-            }
-            size_t new_capacity = capacity_ * 2;
-            SimpleVector<Type> tmp(new_capacity);
+            size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
+            ArrayPtr<Type> tmp(AllocateBuffer(new_capacity));
 
-            move(simp_vec.Get(), simp_vec.Get() + position, tmp.begin());
+            move(simp_vec.Get(), simp_vec.Get() + position, tmp.Get());
             tmp[position] = move(value);
 
-            move(simp_vec.Get() + position, simp_vec.Get() + size_, tmp.begin() + position + 1);
-            simp_vec.swap(tmp.simp_vec);
-            capacity_ = exchange(new_capacity, 0);
+            move(simp_vec.Get() + position, simp_vec.Get() + size_, tmp.Get() + position + 1);
+            ReplaceBuffer(tmp, new_capacity);
         }
         ++size_;
         return simp_vec.Get() + position;
@@ -330,10 +351,30 @@ public:
     }
 
 private:
+    // Выделяет буфер вместимостью не меньше capacity через кеш потока.
+    // capacity получает фактическую вместимость выделенного буфера
+    static Type* AllocateBuffer(size_t& capacity) {
+        return BufferCache<Type>::Allocate(capacity);
+    }
+
+    // Заменяет текущий буфер на new_buffer вместимостью new_capacity,
+    // старый буфер возвращается в кеш потока
+    void ReplaceBuffer(ArrayPtr<Type>& new_buffer, size_t new_capacity) noexcept {
+        BufferCache<Type>::Deallocate(simp_vec.Release(), capacity_);
+        simp_vec.swap(new_buffer);
+        capacity_ = new_capacity;
+    }
+
+    // Переносит элементы в новый буфер вместимостью не меньше new_capacity
+    void Reallocate(size_t new_capacity) {
+        ArrayPtr<Type> tmp(AllocateBuffer(new_capacity));
+        move(simp_vec.Get(), simp_vec.Get() + size_, tmp.Get());
+        ReplaceBuffer(tmp, new_capacity);
+    }
+
     size_t size_ = 0;
     size_t capacity_ = 0;
     ArrayPtr<Type> simp_vec;
-    Type def_value = Type();
 };
 
 template <typename Type>
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Компактный вектор, хранящий размер и вместимость в заголовке перед элементами в куче.
+// Сам объект состоит из одного указателя, пустой вектор не выделяет память.
+// SizeType задаёт тип полей заголовка: uint32_t уменьшает заголовок вдвое,
+// ограничивая размер вектора значением numeric_limits<uint32_t>::max()
+template <typename Type, typename SizeType = size_t>
+class ThinVector {
+    static_assert(is_unsigned_v<SizeType>, "SizeType must be an unsigned integer type");
+    static_assert(alignof(Type) <= alignof(max_align_t), "Over-aligned types are not supported");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    ThinVector() noexcept = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit ThinVector(size_t size) {
+        if (size != 0) {
+            ArrayGuard guard(AllocateHeader(size));
+            uninitialized_value_construct_n(DataOf(guard.header), size);
+            header_ = guard.Release(size);
+        }
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    ThinVector(size_t size, const Type& value) {
+        if (size != 0) {
+            ArrayGuard guard(AllocateHeader(size));
+            uninitialized_fill_n(DataOf(guard.header), size, value);
+            header_ = guard.Release(size);
+        }
+    }
+
+    // Создает вектор заранее заданной емкости с помощью вспомогательного класса обертки
+    ThinVector(const ReserveProxyObj& some_object) {
+        Reserve(some_object.GetCapacity());
+    }
+
+    // Создаёт вектор из std::initializer_list
+    ThinVector(std::initializer_list<Type> init) {
+        if (init.size() != 0) {
+            ArrayGuard guard(AllocateHeader(init.size()));
+            uninitialized_copy(init.begin(), init.end(), DataOf(guard.header));
+            header_ = guard.Release(init.size());
+        }
+    }
+
+    // Конструктор копирования
+    ThinVector(const ThinVector& other) {
+        if (!other.IsEmpty()) {
+            ArrayGuard guard(AllocateHeader(other.GetSize()));
+            uninitialized_copy(other.begin(), other.end(), DataOf(guard.header));
+            header_ = guard.Release(other.GetSize());
+        }
+    }
+
+    ThinVector(ThinVector&& other) noexcept : header_(exchange(other.header_, nullptr)) {
+    }
+
+    ThinVector& operator=(const ThinVector& rhs) {
+        if (this == &rhs)
+            return *this;
+
+        ThinVector tmp(rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    ThinVector& operator=(ThinVector&& rhs) noexcept {
+        if (this == &rhs)
+            return *this;
+
+        ThinVector tmp(move(rhs));
+        swap(tmp);
+        return *this;
+    }
+
+    ~ThinVector() {
+        Destroy();
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        assert(index < GetSize());
+        return begin()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize());
+        return begin()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= GetSize())
+            throw out_of_range("Index is out of range"s);
+        return begin()[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= GetSize())
+            throw out_of_range("Index is out of range"s);
+        return begin()[index];
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return header_ ? header_->size : 0;
+    }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept {
+        return header_ ? header_->capacity : 0;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Возвращает наибольший допустимый размер вектора
+    static constexpr size_t GetMaxSize() noexcept {
+        return static_cast<size_t>(numeric_limits<SizeType>::max()) < MAX_ELEMENTS
+            ? static_cast<size_t>(numeric_limits<SizeType>::max())
+            : MAX_ELEMENTS;
+    }
+
+    // Разрушает элементы, не изменяя вместимость
+    void Clear() noexcept {
+        if (header_) {
+            destroy(begin(), end());
+            header_->size = 0;
+        }
+    }
+
+    Iterator begin() noexcept {
+        return header_ ? DataOf(header_) : nullptr;
+    }
+
+    Iterator end() noexcept {
+        return begin() + GetSize();
+    }
+
+    ConstIterator begin() const noexcept {
+        return header_ ? DataOf(header_) : nullptr;
+    }
+
+    ConstIterator end() const noexcept {
+        return begin() + GetSize();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        const size_t size = GetSize();
+        if (new_size > GetCapacity()) {
+            Reallocate(max(min(GetCapacity() * 2, GetMaxSize()), new_size));
+        }
+        if (new_size > size) {
+            uninitialized_value_construct(begin() + size, begin() + new_size);
+        }
+        else {
+            destroy(begin() + new_size, end());
+        }
+        if (header_) {
+            header_->size = static_cast<SizeType>(new_size);
+        }
+    }
+
+    //Задает емкость вектора
+    //Резервирует нужное количество памяти
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вдвое вместимость вектора
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(move(item));
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        const size_t position = CheckInsertPosition(pos);
+        EmplaceBack(value);
+        rotate(begin() + position, end() - 1, end());
+        return begin() + position;
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        const size_t position = CheckInsertPosition(pos);
+        EmplaceBack(move(value));
+        rotate(begin() + position, end() - 1, end());
+        return begin() + position;
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        if (!IsEmpty()) {
+            --header_->size;
+            end()->~Type();
+        }
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos) {
+        if (IsEmpty() || pos < begin() || pos >= end())
+            throw out_of_range("This position is out of range or vector is empty"s);
+
+        const size_t position = pos - begin();
+        move(begin() + position + 1, end(), begin() + position);
+        PopBack();
+        return begin() + position;
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(ThinVector& other) noexcept {
+        std::swap(header_, other.header_);
+    }
+
+private:
+    struct Header {
+        SizeType size;
+        SizeType capacity;
+    };
+
+    // Смещение первого элемента от начала заголовка с учётом выравнивания Type
+    static constexpr size_t DATA_OFFSET = (sizeof(Header) + alignof(Type) - 1) / alignof(Type) * alignof(Type);
+    static constexpr size_t MAX_ELEMENTS = (numeric_limits<size_t>::max() - DATA_OFFSET) / sizeof(Type);
+
+    // Владеет выделенным, но ещё не переданным вектору блоком памяти.
+    // Освобождает его, если при заполнении было выброшено исключение
+    struct ArrayGuard {
+        explicit ArrayGuard(Header* new_header) noexcept : header(new_header) {
+        }
+
+        ArrayGuard(const ArrayGuard&) = delete;
+        ArrayGuard& operator=(const ArrayGuard&) = delete;
+
+        ~ArrayGuard() {
+            if (header) {
+                ::operator delete(header);
+            }
+        }
+
+        // Прекращает владение блоком, записав в заголовок число построенных элементов
+        Header* Release(size_t size) noexcept {
+            header->size = static_cast<SizeType>(size);
+            return exchange(header, nullptr);
+        }
+
+        Header* header;
+    };
+
+    static Type* DataOf(Header* header) noexcept {
+        return reinterpret_cast<Type*>(reinterpret_cast<char*>(header) + DATA_OFFSET);
+    }
+
+    static const Type* DataOf(const Header* header) noexcept {
+        return reinterpret_cast<const Type*>(reinterpret_cast<const char*>(header) + DATA_OFFSET);
+    }
+
+    // Выделяет блок памяти под заголовок и capacity элементов.
+    // Выбрасывает исключение std::length_error, если capacity не помещается в SizeType
+    static Header* AllocateHeader(size_t capacity) {
+        if (capacity > GetMaxSize())
+            throw length_error("Capacity exceeds the maximum size"s);
+        void* raw = ::operator new(DATA_OFFSET + capacity * sizeof(Type));
+        return new (raw) Header{0, static_cast<SizeType>(capacity)};
+    }
+
+    // Разрушает элементы и освобождает блок памяти
+    void Destroy() noexcept {
+        if (header_) {
+            destroy(begin(), end());
+            ::operator delete(header_);
+            header_ = nullptr;
+        }
+    }
+
+    // Переносит элементы в новый блок вместимостью new_capacity
+    void Reallocate(size_t new_capacity) {
+        ArrayGuard guard(AllocateHeader(new_capacity));
+        uninitialized_move(begin(), end(), DataOf(guard.header));
+        const size_t size = GetSize();
+        Destroy();
+        header_ = guard.Release(size);
+    }
+
+    template <typename Arg>
+    void EmplaceBack(Arg&& item) {
+        const size_t size = GetSize();
+        if (size == GetCapacity()) {
+            if (size == GetMaxSize())
+                throw length_error("Size exceeds the maximum size"s);
+            const size_t new_capacity = size == 0 ? 1 : min(size * 2, GetMaxSize());
+            ArrayGuard guard(AllocateHeader(new_capacity));
+            // Новый элемент строится до переноса старых: item может ссылаться на элемент этого вектора
+            Type* new_item = new (DataOf(guard.header) + size) Type(forward<Arg>(item));
+            try {
+                uninitialized_move(begin(), end(), DataOf(guard.header));
+            }
+            catch (...) {
+                new_item->~Type();
+                throw;
+            }
+            Destroy();
+            header_ = guard.Release(size + 1);
+        }
+        else {
+            new (end()) Type(forward<Arg>(item));
+            ++header_->size;
+        }
+    }
+
+    size_t CheckInsertPosition(ConstIterator pos) const {
+        if (pos < begin() || pos > end())
+            throw out_of_range("This position is out of range"s);
+        return pos - begin();
+    }
+
+    Header* header_ = nullptr;
+};
+
+template <typename Type, typename SizeType>
+inline bool operator==(const ThinVector<Type, SizeType>& lhs, const ThinVector<Type, SizeType>& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename SizeType>
+inline bool operator!=(const ThinVector<Type, SizeType>& lhs, const ThinVector<Type, SizeType>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename SizeType>
+inline bool operator<(const ThinVector<Type, SizeType>& lhs, const ThinVector<Type, SizeType>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename SizeType>
+inline bool operator<=(const ThinVector<Type, SizeType>& lhs, const ThinVector<Type, SizeType>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename SizeType>
+inline bool operator>(const ThinVector<Type, SizeType>& lhs, const ThinVector<Type, SizeType>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename SizeType>
+inline bool operator>=(const ThinVector<Type, SizeType>& lhs, const ThinVector<Type, SizeType>& rhs) {
+    return !(lhs < rhs);
+}
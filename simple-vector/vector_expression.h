@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Ленивые поэлементные выражения над SimpleVector арифметических типов.
+// Выражение вида a = b + c * d не создаёт промежуточных векторов: узлы лишь
+// запоминают операнды, а присваивание вычисляет всё выражение одним циклом.
+// Узлы хранят ссылки на векторы-операнды, поэтому выражение нельзя
+// сохранять дольше, чем живут эти векторы
+
+template <typename Derived>
+class VectorExpression {
+public:
+    const Derived& Self() const noexcept {
+        return static_cast<const Derived&>(*this);
+    }
+};
+
+// Лист выражения: ссылка на вектор
+template <typename Type>
+class VectorReference : public VectorExpression<VectorReference<Type>> {
+public:
+    using ValueType = Type;
+    static constexpr bool IS_SCALAR = false;
+
+    explicit VectorReference(const SimpleVector<Type>& vector) noexcept : data_(vector.begin()), size_(vector.GetSize()) {
+    }
+
+    Type operator[](size_t index) const noexcept {
+        return data_[index];
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+private:
+    const Type* data_;
+    size_t size_;
+};
+
+// Скаляр, размноженный на все позиции выражения
+template <typename Type>
+class ScalarExpression {
+public:
+    using ValueType = Type;
+    static constexpr bool IS_SCALAR = true;
+
+    explicit ScalarExpression(Type value) noexcept : value_(value) {
+    }
+
+    Type operator[](size_t) const noexcept {
+        return value_;
+    }
+
+private:
+    Type value_;
+};
+
+// Поэлементная бинарная операция
+template <typename Lhs, typename Rhs, typename Operation>
+class BinaryExpression : public VectorExpression<BinaryExpression<Lhs, Rhs, Operation>> {
+public:
+    using ValueType = decay_t<invoke_result_t<Operation, typename Lhs::ValueType, typename Rhs::ValueType>>;
+    static constexpr bool IS_SCALAR = false;
+
+    // Выбрасывает исключение std::invalid_argument, если размеры операндов не совпадают
+    BinaryExpression(const Lhs& lhs, const Rhs& rhs) : lhs_(lhs), rhs_(rhs) {
+        if constexpr (!Lhs::IS_SCALAR && !Rhs::IS_SCALAR) {
+            if (lhs_.GetSize() != rhs_.GetSize())
+                throw invalid_argument("Vector sizes do not match"s);
+        }
+    }
+
+    ValueType operator[](size_t index) const {
+        return Operation()(lhs_[index], rhs_[index]);
+    }
+
+    size_t GetSize() const noexcept {
+        if constexpr (Lhs::IS_SCALAR) {
+            return rhs_.GetSize();
+        }
+        else {
+            return lhs_.GetSize();
+        }
+    }
+
+private:
+    Lhs lhs_;
+    Rhs rhs_;
+};
+
+// Применение функции к каждому элементу
+template <typename Operand, typename Function>
+class MapExpression : public VectorExpression<MapExpression<Operand, Function>> {
+public:
+    using ValueType = decay_t<invoke_result_t<const Function&, typename Operand::ValueType>>;
+    static constexpr bool IS_SCALAR = false;
+
+    MapExpression(const Operand& operand, Function function) : operand_(operand), function_(move(function)) {
+    }
+
+    ValueType operator[](size_t index) const {
+        return function_(operand_[index]);
+    }
+
+    size_t GetSize() const noexcept {
+        return operand_.GetSize();
+    }
+
+private:
+    Operand operand_;
+    Function function_;
+};
+
+namespace vector_expression_detail {
+
+template <typename T>
+struct IsArithmeticVector : false_type {};
+
+template <typename Type>
+struct IsArithmeticVector<SimpleVector<Type>> : is_arithmetic<Type> {};
+
+// Операнд, который даёт выражению размер: вектор или другое выражение
+template <typename T>
+inline constexpr bool IS_VECTOR_OPERAND = IsArithmeticVector<T>::value || is_base_of_v<VectorExpression<T>, T>;
+
+template <typename T>
+inline constexpr bool IS_OPERAND = IS_VECTOR_OPERAND<T> || is_arithmetic_v<T>;
+
+template <typename Lhs, typename Rhs>
+using EnableIfOperands = enable_if_t<IS_OPERAND<Lhs> && IS_OPERAND<Rhs> && (IS_VECTOR_OPERAND<Lhs> || IS_VECTOR_OPERAND<Rhs>), int>;
+
+// Приводит операнд к узлу выражения
+template <typename Type>
+VectorReference<Type> ToExpression(const SimpleVector<Type>& vector) noexcept {
+    return VectorReference<Type>(vector);
+}
+
+template <typename Derived>
+const Derived& ToExpression(const VectorExpression<Derived>& expression) noexcept {
+    return expression.Self();
+}
+
+template <typename Type, enable_if_t<is_arithmetic_v<Type>, int> = 0>
+ScalarExpression<Type> ToExpression(Type value) noexcept {
+    return ScalarExpression<Type>(value);
+}
+
+template <typename T>
+using ExpressionOf = decay_t<decltype(ToExpression(declval<const T&>()))>;
+
+template <typename Operation, typename Lhs, typename Rhs>
+BinaryExpression<ExpressionOf<Lhs>, ExpressionOf<Rhs>, Operation> MakeBinary(const Lhs& lhs, const Rhs& rhs) {
+    return BinaryExpression<ExpressionOf<Lhs>, ExpressionOf<Rhs>, Operation>(ToExpression(lhs), ToExpression(rhs));
+}
+
+} // namespace vector_expression_detail
+
+template <typename Lhs, typename Rhs, vector_expression_detail::EnableIfOperands<Lhs, Rhs> = 0>
+inline auto operator+(const Lhs& lhs, const Rhs& rhs) {
+    return vector_expression_detail::MakeBinary<std::plus<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, vector_expression_detail::EnableIfOperands<Lhs, Rhs> = 0>
+inline auto operator-(const Lhs& lhs, const Rhs& rhs) {
+    return vector_expression_detail::MakeBinary<std::minus<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, vector_expression_detail::EnableIfOperands<Lhs, Rhs> = 0>
+inline auto operator*(const Lhs& lhs, const Rhs& rhs) {
+    return vector_expression_detail::MakeBinary<std::multiplies<>>(lhs, rhs);
+}
+
+template <typename Lhs, typename Rhs, vector_expression_detail::EnableIfOperands<Lhs, Rhs> = 0>
+inline auto operator/(const Lhs& lhs, const Rhs& rhs) {
+    return vector_expression_detail::MakeBinary<std::divides<>>(lhs, rhs);
+}
+
+// Возвращает ленивое выражение, применяющее function к каждому элементу operand
+template <typename Operand, typename Function, enable_if_t<vector_expression_detail::IS_VECTOR_OPERAND<Operand>, int> = 0>
+inline auto Map(const Operand& operand, Function function) {
+    using Expression = vector_expression_detail::ExpressionOf<Operand>;
+    return MapExpression<Expression, Function>(vector_expression_detail::ToExpression(operand), move(function));
+}
+
+// Возвращает сумму элементов вектора или выражения, вычисленную за один проход
+template <typename Operand, enable_if_t<vector_expression_detail::IS_VECTOR_OPERAND<Operand>, int> = 0>
+inline auto Sum(const Operand& operand) {
+    const auto& expr = vector_expression_detail::ToExpression(operand);
+    using ValueType = typename vector_expression_detail::ExpressionOf<Operand>::ValueType;
+    ValueType result = ValueType();
+    const size_t size = expr.GetSize();
+    for (size_t i = 0; i < size; ++i) {
+        result += expr[i];
+    }
+    return result;
+}
+
+// Возвращает скалярное произведение
+// Выбрасывает исключение std::invalid_argument, если размеры операндов не совпадают
+template <typename Lhs, typename Rhs,
+          enable_if_t<vector_expression_detail::IS_VECTOR_OPERAND<Lhs> && vector_expression_detail::IS_VECTOR_OPERAND<Rhs>, int> = 0>
+inline auto Dot(const Lhs& lhs, const Rhs& rhs) {
+    return Sum(lhs * rhs);
+}